@@ -83,3 +83,79 @@ size_t Esp8266_Communicator::sendCommand(const __FlashStringHelper* command, cha
     // Submit and read
     return submitAndRead(buffer, size, timeout);
 }
+
+bool Esp8266_Communicator::sendCommandAndWait(const char* command, const char* target, unsigned long timeout)
+{
+    // Write commmand
+    auto length = strlen(command);
+    if (write((const uint8_t*)command, length) != length) return false;
+    if (submitCommand() == false) return false;
+    // Wait for prompt or reply header
+    return waitFor(target, "ERROR", timeout);
+}
+
+bool Esp8266_Communicator::waitFor(const char* target, const char* failure, unsigned long timeout)
+{
+    // Set new timeout
+    auto t = CSerial::getTimeout();
+    CSerial::setTimeout(timeout);
+    size_t ti = 0, fi = 0;
+    bool found = false;
+    while (1) {
+        auto ch = CSerial::timedRead();
+        if (ch < 0) break;
+        // Restart match (neither target nor failure repeat their first character)
+        ti = ch == target[ti] ? ti + 1 : (ch == target[0] ? 1 : 0);
+        if (target[ti] == '\0') { found = true; break; }
+        if (failure != nullptr) {
+            fi = ch == failure[fi] ? fi + 1 : (ch == failure[0] ? 1 : 0);
+            if (failure[fi] == '\0') {
+                // Consume the rest of the failure line
+                while (ch >= 0 && ch != '\n') ch = CSerial::timedRead();
+                break;
+            }
+        }
+    }
+    // Unset timeout
+    CSerial::setTimeout(t);
+    return found;
+}
+
+void Esp8266_Communicator::drain(unsigned long timeout)
+{
+    // Set new timeout
+    auto t = CSerial::getTimeout();
+    CSerial::setTimeout(timeout);
+    // Discard until the line goes quiet
+    while (CSerial::timedRead() >= 0);
+    // Unset timeout
+    CSerial::setTimeout(t);
+}
+
+size_t Esp8266_Communicator::writeData(const uint8_t* buffer, const size_t size)
+{
+    // Data sent after the '>' prompt is not echoed back
+    return CSerial::write(buffer, size);
+}
+
+size_t Esp8266_Communicator::readData(uint8_t* buffer, const size_t size, unsigned long timeout)
+{
+    // Set new timeout
+    auto t = CSerial::getTimeout();
+    CSerial::setTimeout(timeout);
+    // Read buffer
+    auto c = CSerial::readBytes(buffer, size);
+    // Unset timeout
+    CSerial::setTimeout(t);
+    return c;
+}
+
+size_t Esp8266_Communicator::readAvailable(char* buffer, const size_t size)
+{
+    size_t c = 0;
+    while (c < size && CSerial::available() > 0) {
+        buffer[c] = CSerial::read();
+        c++;
+    }
+    return c;
+}
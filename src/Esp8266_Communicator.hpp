@@ -20,6 +20,7 @@ public:
 
     using CSerial::begin;
     using CSerial::end;
+    using CSerial::available;
 
     size_t write(const uint8_t* buffer, const size_t size);
 
@@ -32,4 +33,16 @@ public:
     size_t sendCommand(const char* command, char* buffer, const size_t size, unsigned long timeout);
 
     size_t sendCommand(const __FlashStringHelper* command, char* buffer, const size_t size, unsigned long timeout);
+
+    bool sendCommandAndWait(const char* command, const char* target, unsigned long timeout);
+
+    bool waitFor(const char* target, const char* failure, unsigned long timeout);
+
+    void drain(unsigned long timeout);
+
+    size_t writeData(const uint8_t* buffer, const size_t size);
+
+    size_t readData(uint8_t* buffer, const size_t size, unsigned long timeout);
+
+    size_t readAvailable(char* buffer, const size_t size);
 };
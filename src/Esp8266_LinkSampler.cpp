@@ -0,0 +1,159 @@
+#include "Esp8266_LinkSampler.hpp"
+
+#include "utils/BufferUtil.hpp"
+
+void Esp8266_LinkSampler::startProbe(const Probe next)
+{
+    if (next == Probe::PING) {
+        // AT+PING=<"host">
+        strlcpy_P(reply, PSTR("AT+PING=\""), sizeof(reply));
+        strlcat(reply, args.host, sizeof(reply));
+        strlcat_P(reply, PSTR("\""), sizeof(reply));
+    }
+    else {
+        // AT+CWJAP?
+        strlcpy_P(reply, PSTR("AT+CWJAP?"), sizeof(reply));
+    }
+    probe = next;
+    probeStart = millis();
+    length = 0;
+    parsed = false;
+    recorded = false;
+    // Submit without waiting for the echo, it is checked while collecting
+    commandLength = strlen(reply);
+    reply[commandLength] = '\r';
+    const uint8_t newline = '\n';
+    wifi.writeData((const uint8_t*)reply, commandLength + 1);
+    wifi.writeData(&newline, 1);
+    echoed = 0;
+    echoing = true;
+}
+
+bool Esp8266_LinkSampler::parseReply()
+{
+    auto p = strstr_P(reply, probe == Probe::PING ? PSTR("+PING:") : PSTR("+CWJAP:"));
+    if (p == nullptr) return false;
+    p = strchr(p, ':') + 1;
+    // Wait for the whole line
+    auto end = strchr(p, '\r');
+    if (end == nullptr) return false;
+    if (probe == Probe::RSSI) {
+        // +CWJAP:<ssid>,<bssid>,<channel>,<rssi>,...
+        uint8_t commas = 0;
+        bool quoted = false;
+        while (p < end && commas < 3) {
+            if (*p == '\"') quoted = !quoted;
+            else if (*p == ',' && !quoted) commas++;
+            p++;
+        }
+        if (commas < 3 || p == end) return false;
+    }
+    // +PING:<time> or +PING:TIMEOUT
+    if (*p != '-' && (*p < '0' || *p > '9')) return false;
+    int16_t value;
+    BufferUtil::readNumber(value, p, end - p, ',', '\r');
+    (probe == Probe::PING ? latency : rssi).add(value);
+    return true;
+}
+
+void Esp8266_LinkSampler::notify(bool& state, const bool crossed, const LinkEvent high, const LinkEvent low, const int16_t value)
+{
+    if (state == crossed) return;
+    state = crossed;
+    if (args.callback != nullptr) args.callback(crossed ? high : low, value, args.context);
+}
+
+void Esp8266_LinkSampler::recordProbe()
+{
+    recorded = true;
+    // No AP, ping timeout or malformed reply
+    if (!parsed) (probe == Probe::PING ? latency : rssi).addLost();
+}
+
+void Esp8266_LinkSampler::checkThresholds(const Probe done)
+{
+    if (done == Probe::PING) {
+        if (latency.hasValue()) {
+            notify(latencyHigh, latency.ewma() > args.latency_high,
+                LinkEvent::LATENCY_HIGH, LinkEvent::LATENCY_RECOVERED, latency.ewma());
+        }
+        if (latency.size() >= args.loss_samples) {
+            notify(lossHigh, latency.lossRate() > args.loss_high,
+                LinkEvent::LOSS_HIGH, LinkEvent::LOSS_RECOVERED, latency.lossRate());
+        }
+    }
+    else {
+        if (rssi.hasValue()) {
+            notify(rssiLow, rssi.ewma() < args.rssi_low,
+                LinkEvent::RSSI_LOW, LinkEvent::RSSI_RECOVERED, rssi.ewma());
+        }
+    }
+}
+
+void Esp8266_LinkSampler::finishProbe()
+{
+    if (!recorded) recordProbe();
+    auto done = probe;
+    probe = Probe::NONE;
+    length = 0;
+    parsed = false;
+    // Callbacks may send commands, so only notify once the probe is off the UART
+    checkThresholds(done);
+}
+
+void Esp8266_LinkSampler::collect(const char ch)
+{
+    // Command echo, followed by the echo of '\r'
+    if (echoing) {
+        if (ch == reply[echoed]) {
+            echoed++;
+            echoing = echoed <= commandLength;
+            return;
+        }
+        // Echo mismatch, treat everything from here on as reply
+        echoing = false;
+    }
+    // Reply too long, keep only the tail for terminator matching
+    if (length == sizeof(reply) - 1) {
+        memmove(reply, reply + length - 8, 8);
+        length = 8;
+    }
+    reply[length++] = ch;
+    reply[length] = '\0';
+    if (ch != '\n') return;
+    // Late replies after a timeout are only drained
+    if (!parsed && !recorded) parsed = parseReply();
+    // Final result line
+    if ((length >= 5 && strcmp_P(reply + length - 5, PSTR("\nOK\r\n")) == 0) ||
+        (length >= 8 && strcmp_P(reply + length - 8, PSTR("\nERROR\r\n")) == 0)) finishProbe();
+}
+
+void Esp8266_LinkSampler::tick()
+{
+    auto now = millis();
+    if (probe == Probe::NONE) {
+        if (now - lastProbe < args.interval) return;
+        // Don't get in the way of incoming data, retry on next tick
+        if (wifi.available() > 0) return;
+        lastProbe = now;
+        probeCount++;
+        auto ping = args.host != nullptr && probeCount >= args.ping_every;
+        if (ping) probeCount = 0;
+        startProbe(ping ? Probe::PING : Probe::RSSI);
+        return;
+    }
+    // One byte at a time so data following the final result stays in the UART buffer
+    char ch;
+    while (probe != Probe::NONE && wifi.readAvailable(&ch, 1) == 1) collect(ch);
+    if (probe == Probe::NONE) return;
+    auto timeout = probe == Probe::PING ? args.ping_timeout : args.rssi_timeout;
+    // No final result at all (modem reset or RX overflow), give up on the probe
+    if (now - probeStart > 2 * timeout) finishProbe();
+    // Count as lost, but keep draining until the final result arrives
+    else if (!recorded && now - probeStart > timeout) recordProbe();
+}
+
+bool Esp8266_LinkSampler::isBusy() const
+{
+    return probe != Probe::NONE;
+}
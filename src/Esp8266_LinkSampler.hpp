@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Esp8266_WiFi.hpp"
+#include "utils/StatisticsUtil.hpp"
+
+enum class LinkEvent : int8_t {
+    // EWMA of RSSI dropped below <rssi_low>.
+    RSSI_LOW = 0,
+    // EWMA of RSSI rose back to <rssi_low> or above.
+    RSSI_RECOVERED = 1,
+    // EWMA of ping round-trip time rose above <latency_high>.
+    LATENCY_HIGH = 2,
+    // EWMA of ping round-trip time fell back to <latency_high> or below.
+    LATENCY_RECOVERED = 3,
+    // Ping loss rate in the window rose above <loss_high>.
+    LOSS_HIGH = 4,
+    // Ping loss rate in the window fell back to <loss_high> or below.
+    LOSS_RECOVERED = 5
+};
+
+// Called on threshold crossings with the value that crossed it.
+using LinkCallback = void (*)(LinkEvent event, int16_t value, void* context);
+
+struct LinkSamplerArgs {
+    // <host>: ping target, usually the gateway. nullptr disables latency probing.
+    const char* host = nullptr;
+    // <interval>: time between probes. Unit: millisecond. Default: 1000.
+    unsigned long interval = 1000;
+    // <ping_every>: every n-th probe is a ping, the rest are RSSI reads. Default: 4.
+    uint8_t ping_every = 4;
+    // <rssi_timeout>: maximum wait for the AT+CWJAP? reply. The probe is abandoned after twice this long. Unit: millisecond. Default: 500.
+    unsigned long rssi_timeout = 500;
+    // <ping_timeout>: maximum wait for the AT+PING reply, including the DNS lookup of <host>. The probe is abandoned after twice this long. Unit: millisecond. Default: 10000.
+    unsigned long ping_timeout = 10000;
+    // <rssi_low>: signal strength threshold. Unit: dBm. Default: -80.
+    int16_t rssi_low = -80;
+    // <latency_high>: round-trip time threshold. Unit: millisecond. Default: 200.
+    int16_t latency_high = 200;
+    // <loss_high>: ping loss rate threshold. Unit: percent. Default: 25.
+    uint8_t loss_high = 25;
+    // <loss_samples>: minimum number of pings in the window before <loss_high> is checked. Default: 8. Range: [1,16].
+    uint8_t loss_samples = 8;
+    // <callback>: threshold crossing notification. Optional.
+    LinkCallback callback = nullptr;
+    // <context>: passed to callback.
+    void* context = nullptr;
+};
+
+// Samples link quality in the background. tick() doesn't wait for replies:
+// it sends a probe when one is due (blocking only while the transmit buffer
+// is full) and collects the echo and reply on later ticks. Bytes after the
+// final OK/ERROR are left unread for the caller, but anything else received
+// while a probe is in flight, including +IPD data, is consumed and lost. On
+// busy links keep probes rare (<interval>, <ping_every>) and give <host> as
+// an IP address so AT+PING doesn't wait on DNS.
+// Other commands must not be sent while isBusy() returns true.
+class Esp8266_LinkSampler {
+private:
+    enum class Probe : int8_t {
+        NONE = 0,
+        RSSI = 1,
+        PING = 2
+    };
+
+    Esp8266_WiFi& wifi;
+    LinkSamplerArgs args;
+
+    Probe probe = Probe::NONE;
+    unsigned long lastProbe = 0;
+    unsigned long probeStart = 0;
+    uint8_t probeCount = 0;
+
+    char reply[128];
+    size_t length = 0;
+    size_t commandLength = 0;
+    size_t echoed = 0;
+    bool echoing = false;
+    bool parsed = false;
+    bool recorded = false;
+
+    bool rssiLow = false;
+    bool latencyHigh = false;
+    bool lossHigh = false;
+
+    void startProbe(const Probe next);
+    void collect(const char ch);
+    void recordProbe();
+    void checkThresholds(const Probe done);
+    void finishProbe();
+    bool parseReply();
+    void notify(bool& state, const bool crossed, const LinkEvent high, const LinkEvent low, const int16_t value);
+public:
+    static constexpr size_t WINDOW = 16;
+
+    StatisticsUtil::RingStatistics<WINDOW> rssi;
+    StatisticsUtil::RingStatistics<WINDOW> latency;
+
+    Esp8266_LinkSampler(Esp8266_WiFi& wifi, const LinkSamplerArgs& args) : wifi(wifi), args(args) {}
+
+    void tick();
+
+    bool isBusy() const;
+};
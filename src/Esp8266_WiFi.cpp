@@ -2,6 +2,7 @@
 
 #include "utils/BufferUtil.hpp"
 #include "utils/ArgumentsUtil.hpp"
+#include "utils/CrcUtil.hpp"
 
 bool Esp8266_WiFi::sendBasicCommand(const __FlashStringHelper* command, unsigned long timeout)
 {
@@ -35,6 +36,64 @@ size_t Esp8266_WiFi::sendBasicCommandWithReply(unsigned long timeout)
     return count - 6;
 }
 
+bool Esp8266_WiFi::transfer(PGM_P command, const char* name, uint32_t offset, uint32_t length,
+    const TransferArgs& args, TransferResult& result)
+{
+    result = {};
+    if (args.reader == nullptr || args.chunk_buffer == nullptr || args.chunk_buffer_size < 2) return false;
+    auto half = args.chunk_buffer_size / 2;
+    auto current = args.chunk_buffer;
+    auto next = args.chunk_buffer + half;
+    auto crc = CrcUtil::CRC32_INIT;
+    auto start = millis();
+    auto count = args.reader(current, length < half ? length : half, args.context);
+    while (count > 0) {
+        // <command><"name">,<offset>,<length>
+        if (!createCommand<false>(buffer, sizeof(buffer), command,
+            name, offset + result.transferred, (uint32_t)count)) return false;
+        if (!sendCommandAndWait(buffer, ">", 1000)) { drain(100); return false; }
+        if (writeData(current, count) != count) { drain(100); return false; }
+        crc = CrcUtil::crc32(crc, current, count);
+        // Read the next chunk while the ESP32 is writing this one
+        auto remaining = length - result.transferred - count;
+        auto nextCount = remaining > 0 ? args.reader(next, remaining < half ? remaining : half, args.context) : 0;
+        if (!waitFor("OK\r\n", "ERROR", 3000)) { drain(100); return false; }
+        result.transferred += count;
+        result.elapsed = millis() - start;
+        result.bytes_per_second = result.elapsed > 0 ? (uint64_t)result.transferred * 1000 / result.elapsed : 0;
+        if (args.progress != nullptr) {
+            args.progress(result.transferred, length, result.bytes_per_second, args.context);
+        }
+        auto t = current; current = next; next = t;
+        count = nextCount;
+    }
+    result.crc = CrcUtil::crc32Final(crc);
+    return result.transferred == length;
+}
+
+bool Esp8266_WiFi::verifyTransfer(PGM_P command, const char* header, const char* name, uint32_t offset, uint32_t length,
+    const TransferArgs& args, uint32_t crc)
+{
+    if (args.chunk_buffer == nullptr || args.chunk_buffer_size == 0) return false;
+    auto size = args.chunk_buffer_size;
+    auto check = CrcUtil::CRC32_INIT;
+    uint32_t done = 0;
+    while (done < length) {
+        size_t count = length - done < size ? length - done : size;
+        // <command><"name">,<offset>,<length>
+        if (!createCommand<false>(buffer, sizeof(buffer), command,
+            name, offset + done, (uint32_t)count)) return false;
+        // <header><length>,<data>
+        if (!sendCommandAndWait(buffer, header, 1000)) { drain(100); return false; }
+        if (!waitFor(",", nullptr, 500)) { drain(100); return false; }
+        if (readData(args.chunk_buffer, count, 1000) != count) { drain(100); return false; }
+        if (!waitFor("OK\r\n", "ERROR", 500)) { drain(100); return false; }
+        check = CrcUtil::crc32(check, args.chunk_buffer, count);
+        done += count;
+    }
+    return CrcUtil::crc32Final(check) == crc;
+}
+
 bool Esp8266_WiFi::setMode(const Mode mode, const bool auto_connect)
 {
     // AT+CWMODE=<mode>[,<auto_connect>]
@@ -166,3 +225,39 @@ bool Esp8266_WiFi::getServerStatus(ServerStatus& status)
     return parseArguments(buffer + 11, c - 11,
         status.mode, status.port, status.type, status.ca_enable);
 }
+
+bool Esp8266_WiFi::eraseSystemFlash(const char* partition, uint32_t offset, uint32_t length)
+{
+    // AT+SYSFLASH=<operation>,<"partition">,<offset>,<length>
+    if (!createCommand<false>(buffer, sizeof(buffer), PSTR("AT+SYSFLASH=0,"),
+        partition, offset, length)) return false;
+    return sendBasicCommand(10000);
+}
+
+bool Esp8266_WiFi::writeSystemFlash(const char* partition, uint32_t offset, uint32_t length,
+    const TransferArgs& args, TransferResult& result)
+{
+    // AT+SYSFLASH=<operation>,<"partition">,<offset>,<length>
+    if (!transfer(PSTR("AT+SYSFLASH=1,"), partition, offset, length, args, result)) return false;
+    if (!args.verify) return true;
+    // +SYSFLASH:<length>,<data>
+    return verifyTransfer(PSTR("AT+SYSFLASH=2,"), "+SYSFLASH:", partition, offset, length, args, result.crc);
+}
+
+bool Esp8266_WiFi::deleteFile(const char* filename)
+{
+    // AT+FS=<type>,<operation>,<"filename">
+    if (!createCommand<false>(buffer, sizeof(buffer), PSTR("AT+FS=0,0,"),
+        filename)) return false;
+    return sendBasicCommand(1000);
+}
+
+bool Esp8266_WiFi::writeFile(const char* filename, uint32_t offset, uint32_t length,
+    const TransferArgs& args, TransferResult& result)
+{
+    // AT+FS=<type>,<operation>,<"filename">,<offset>,<length>
+    if (!transfer(PSTR("AT+FS=0,1,"), filename, offset, length, args, result)) return false;
+    if (!args.verify) return true;
+    // +FS:<length>,<data>
+    return verifyTransfer(PSTR("AT+FS=0,2,"), "+FS:", filename, offset, length, args, result.crc);
+}
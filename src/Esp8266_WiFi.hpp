@@ -149,6 +149,38 @@ struct DeleteServerArgs {
     int8_t ca_enable = -1;
 };
 
+// Fills buffer with the next bytes of the transfer, returns the number of bytes read.
+using TransferReader = size_t (*)(uint8_t* buffer, size_t size, void* context);
+
+// Called after every acknowledged chunk.
+using TransferProgress = void (*)(uint32_t transferred, uint32_t total, uint32_t bytes_per_second, void* context);
+
+struct TransferArgs {
+    // <reader>: source of the transferred data.
+    TransferReader reader = nullptr;
+    // <progress>: progress and throughput reporting. Optional.
+    TransferProgress progress = nullptr;
+    // <context>: passed to reader and progress.
+    void* context = nullptr;
+    // <chunk_buffer>: scratch buffer. Split in two halves so the next chunk is read while the ESP32 writes the previous one.
+    uint8_t* chunk_buffer = nullptr;
+    // <chunk_buffer_size>: size of the scratch buffer. Each chunk is half of it.
+    size_t chunk_buffer_size = 0;
+    // <verify>: read the written data back and compare CRC32. Default: false.
+    bool verify = false;
+};
+
+struct TransferResult {
+    // <transferred>: number of bytes acknowledged by the ESP32.
+    uint32_t transferred;
+    // <crc>: CRC32 of the transferred data.
+    uint32_t crc;
+    // <elapsed>: duration of the write pass. Unit: millisecond.
+    uint32_t elapsed;
+    // <bytes_per_second>: average throughput of the write pass.
+    uint32_t bytes_per_second;
+};
+
 class Esp8266_WiFi : public Esp8266_Communicator {
 private:
     bool sendBasicCommand(const __FlashStringHelper* command, unsigned long timeout);
@@ -156,6 +188,11 @@ private:
     
     size_t sendBasicCommandWithReply(const __FlashStringHelper* command, unsigned long timeout);
     size_t sendBasicCommandWithReply(unsigned long timeout);
+
+    bool transfer(PGM_P command, const char* name, uint32_t offset, uint32_t length,
+        const TransferArgs& args, TransferResult& result);
+    bool verifyTransfer(PGM_P command, const char* header, const char* name, uint32_t offset, uint32_t length,
+        const TransferArgs& args, uint32_t crc);
 public:
     char buffer[255];
 
@@ -181,4 +218,12 @@ public:
     bool createServer(const CreateServerArgs& args);
     bool deleteServer(const DeleteServerArgs& args);
     bool getServerStatus(ServerStatus& status);
+
+    bool eraseSystemFlash(const char* partition, uint32_t offset, uint32_t length);
+    bool writeSystemFlash(const char* partition, uint32_t offset, uint32_t length,
+        const TransferArgs& args, TransferResult& result);
+
+    bool deleteFile(const char* filename);
+    bool writeFile(const char* filename, uint32_t offset, uint32_t length,
+        const TransferArgs& args, TransferResult& result);
 };
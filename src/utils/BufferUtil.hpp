@@ -6,18 +6,23 @@
 namespace BufferUtil {
     template<typename T>
     size_t copyNumber(char* dest, T src, size_t destsize) {
-        T n = 1;
-        while (src > n) {
-            if (destsize == 0) return 0;
-            n *= 100;
-            destsize--;
+        if constexpr (!is_unsigned<T>::value) {
+            if (src < 0) {
+                if (destsize == 0) return 0;
+                *dest = '-';
+                // Negate as unsigned so the minimum value doesn't overflow
+                unsigned long abs = 0UL - (unsigned long)src;
+                return copyNumber(dest + 1, abs, destsize - 1) + 1;
+            }
         }
-        if (n / 10 > src) n /= 10;
+        T n = 1;
+        while (src / n >= 10) n *= 10;
         size_t c = 0;
-        while (n != 1) {
-            n /= 10;
+        while (n != 0) {
+            if (c == destsize) return c;
             *dest = (src / n) + '0';
             src %= n;
+            n /= 10;
             dest++;
             c++;
         }
@@ -32,8 +37,7 @@ namespace BufferUtil {
         size_t c = neg ? 1 : 0;
         while (c < srcsize) {
             if ((... || (src[c] == terminators))) break;
-            dest += src[c] - '0';
-            dest *= 10; // base = 10
+            dest = dest * 10 + (src[c] - '0'); // base = 10
             c++;
         }
         if (neg) dest *= -1;
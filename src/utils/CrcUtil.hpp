@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CrcUtil {
+    constexpr uint32_t CRC32_INIT = 0xFFFFFFFF;
+
+    // CRC-32 (IEEE 802.3), processed a nibble at a time to keep the table small
+    inline uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size)
+    {
+        static constexpr uint32_t table[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+            0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+            0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+        };
+        while (size > 0) {
+            crc ^= *data;
+            crc = (crc >> 4) ^ table[crc & 0x0F];
+            crc = (crc >> 4) ^ table[crc & 0x0F];
+            data++;
+            size--;
+        }
+        return crc;
+    }
+
+    inline uint32_t crc32Final(uint32_t crc)
+    {
+        return crc ^ 0xFFFFFFFF;
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace StatisticsUtil {
+    // Fixed-size window of samples with an exponentially weighted moving average (alpha = 1 / 2^Shift)
+    template<size_t N, uint8_t Shift = 3>
+    class RingStatistics {
+    private:
+        static constexpr int16_t LOST = INT16_MIN;
+
+        int16_t samples[N];
+        size_t head = 0;
+        size_t count = 0;
+        // EWMA in 24.8 fixed point
+        int32_t average = 0;
+        bool hasAverage = false;
+
+        void push(int16_t sample)
+        {
+            samples[head] = sample;
+            head = (head + 1) % N;
+            if (count < N) count++;
+        }
+    public:
+        void add(int16_t sample)
+        {
+            if (sample == LOST) sample++;
+            push(sample);
+            int32_t s = (int32_t)sample * 256;
+            if (!hasAverage) {
+                average = s;
+                hasAverage = true;
+            }
+            else average += (s - average) / (1 << Shift);
+        }
+
+        void addLost()
+        {
+            push(LOST);
+        }
+
+        void clear()
+        {
+            head = 0;
+            count = 0;
+            hasAverage = false;
+        }
+
+        // Number of samples in the window, including lost ones
+        size_t size() const { return count; }
+
+        bool hasValue() const { return hasAverage; }
+
+        int16_t last() const
+        {
+            if (count == 0) return LOST;
+            return samples[(head + N - 1) % N];
+        }
+
+        bool lastLost() const { return last() == LOST; }
+
+        int16_t minimum() const
+        {
+            int16_t m = INT16_MAX;
+            for (size_t i = 0; i < count; i++) {
+                if (samples[i] != LOST && samples[i] < m) m = samples[i];
+            }
+            return m;
+        }
+
+        int16_t maximum() const
+        {
+            int16_t m = INT16_MIN;
+            for (size_t i = 0; i < count; i++) {
+                if (samples[i] != LOST && samples[i] > m) m = samples[i];
+            }
+            return m;
+        }
+
+        int16_t mean() const
+        {
+            int32_t sum = 0;
+            size_t c = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (samples[i] == LOST) continue;
+                sum += samples[i];
+                c++;
+            }
+            return c > 0 ? sum / (int32_t)c : 0;
+        }
+
+        int16_t ewma() const { return average / 256; }
+
+        // Percentage of lost samples in the window
+        uint8_t lossRate() const
+        {
+            if (count == 0) return 0;
+            size_t lost = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (samples[i] == LOST) lost++;
+            }
+            return lost * 100 / count;
+        }
+    };
+}